@@ -33,8 +33,12 @@
 #import <SalesforceCommonUtils/SFLogger.h>
 #import "Swifty-Bridging-Header.h"
 #import "Swifty-Swift.h"
+#import "SmartStoreBenchmark.h"
 
 
+// Launch with "-SmartStoreBenchmark YES" to run the SmartStore benchmark after login.
+static NSString * const SmartStoreBenchmarkDefaultsKey = @"SmartStoreBenchmark";
+
 // Fill these in when creating a new Connected Application on Force.com
 static NSString * const RemoteAccessConsumerKey = @"3MVG9Iu66FKeHhINkB1l7xt7kR8czFcCTUhgoA8Ol2Ltf1eYHOU4SqQRSEitYFDUpqRWcoQ2.dBv_a1Dyu5xa";
 static NSString * const OAuthRedirectURI        = @"testsfdc:///mobilesdk/detect/oauth/done";
@@ -62,6 +66,12 @@ static NSString * const OAuthRedirectURI        = @"testsfdc:///mobilesdk/detect
  */
 - (void)initializeAppViewState;
 
+/**
+ * Runs the SmartStore benchmark in the background, then logs the report and writes it to
+ * SmartStoreBenchmark.json in the Documents directory.
+ */
+- (void)runSmartStoreBenchmark;
+
 @end
 
 @implementation AppDelegate
@@ -90,6 +100,9 @@ static NSString * const OAuthRedirectURI        = @"testsfdc:///mobilesdk/detect
         __weak AppDelegate *weakSelf = self;
         self.initialLoginSuccessBlock = ^(SFOAuthInfo *info) {
             [weakSelf setupRootViewController];
+            if ([[NSUserDefaults standardUserDefaults] boolForKey:SmartStoreBenchmarkDefaultsKey]) {
+                [weakSelf runSmartStoreBenchmark];
+            }
         };
         self.initialLoginFailureBlock = ^(SFOAuthInfo *info, NSError *error) {
             [[SFAuthenticationManager sharedManager] logout];
@@ -157,6 +170,18 @@ static NSString * const OAuthRedirectURI        = @"testsfdc:///mobilesdk/detect
     self.window.rootViewController = navVC;
 }
 
+- (void)runSmartStoreBenchmark
+{
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSData *report = [[[SmartStoreBenchmark alloc] init] run];
+        NSString *documentsPath = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        NSString *reportPath = [documentsPath stringByAppendingPathComponent:@"SmartStoreBenchmark.json"];
+        [report writeToFile:reportPath atomically:YES];
+        [self log:SFLogLevelInfo format:@"SmartStore benchmark report written to %@:\n%@",
+         reportPath, [[NSString alloc] initWithData:report encoding:NSUTF8StringEncoding]];
+    });
+}
+
 #pragma mark - SFAuthenticationManagerDelegate
 
 - (void)authManagerDidLogout:(SFAuthenticationManager *)manager
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <SalesforceNativeSDK/SFRestAPI.h>
+
+/**
+ * A caller's request and the delegate to notify of its outcome.
+ */
+@interface RestDelegateTarget : NSObject
+
+@property (nonatomic, strong, readonly) SFRestRequest *request;
+
+/**
+ * Held weakly, like `SFRestRequest.delegate`.
+ */
+@property (nonatomic, weak, readonly) id<SFRestDelegate> delegate;
+
+- (id)initWithRequest:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate;
+
+/**
+ * Each of these calls the matching SFRestDelegate method with `request`, if the delegate implements it.
+ */
+- (void)didLoadResponse:(id)response;
+- (void)didFailLoadWithError:(NSError *)error;
+- (void)didCancelLoad;
+- (void)didTimeout;
+
+@end
+
+/**
+ * Stands in as the delegate of a request sent by one of the app's SFRestAPI categories,
+ * and forwards the outcome to its targets.  Subclasses override the SFRestDelegate methods
+ * to change what is forwarded, or `targetsForRequest:` to change who it is forwarded to.
+ *
+ * Threading: the app uses SFRestAPI from the main queue only (RootVC sends from viewDidLoad),
+ * and the categories keep to that: they send and cancel requests, and notify targets, on the
+ * main queue, whatever queue their own callers are on.
+ */
+@interface RestDelegateForwarder : NSObject <SFRestDelegate>
+
+/**
+ * The targets notified of the outcome.  Subclasses that change it while a request is in flight
+ * are responsible for guarding it.
+ */
+@property (nonatomic, strong, readonly) NSMutableArray *targets;
+
+/**
+ * Adds a target for the given caller request and delegate.
+ * @return the new target
+ */
+- (RestDelegateTarget *)addTargetWithRequest:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate;
+
+/**
+ * Sends `request` through `restApi` with the receiver as its delegate.  Requests only hold their
+ * delegate weakly, so the request keeps the receiver alive until `finishRequest:`.
+ * @return the SFNetworkOperation carrying the request
+ */
+- (SFNetworkOperation *)sendRequest:(SFRestRequest *)request withRestApi:(SFRestAPI *)restApi;
+
+/**
+ * Lets `request` release the receiver.  Called by each SFRestDelegate method once the targets
+ * have been notified; subclasses overriding one without calling super must call it themselves.
+ */
+- (void)finishRequest:(SFRestRequest *)request;
+
+/**
+ * The targets to notify of the outcome of `request`.  Returns a copy of `targets` by default.
+ */
+- (NSArray *)targetsForRequest:(SFRestRequest *)request;
+
+@end
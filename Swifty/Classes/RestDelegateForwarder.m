@@ -0,0 +1,162 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <objc/runtime.h>
+#import "RestDelegateForwarder.h"
+
+static char kRestDelegateForwarderKey;
+
+@interface RestDelegateTarget ()
+
+@property (nonatomic, strong, readwrite) SFRestRequest *request;
+@property (nonatomic, weak, readwrite) id<SFRestDelegate> delegate;
+
+@end
+
+@implementation RestDelegateTarget
+
+- (id)initWithRequest:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate
+{
+    self = [super init];
+    if (self) {
+        _request = request;
+        _delegate = delegate;
+    }
+    return self;
+}
+
+- (void)didLoadResponse:(id)response
+{
+    id<SFRestDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(request:didLoadResponse:)]) {
+        [delegate request:self.request didLoadResponse:response];
+    }
+}
+
+- (void)didFailLoadWithError:(NSError *)error
+{
+    id<SFRestDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(request:didFailLoadWithError:)]) {
+        [delegate request:self.request didFailLoadWithError:error];
+    }
+}
+
+- (void)didCancelLoad
+{
+    id<SFRestDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(requestDidCancelLoad:)]) {
+        [delegate requestDidCancelLoad:self.request];
+    }
+}
+
+- (void)didTimeout
+{
+    id<SFRestDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(requestDidTimeout:)]) {
+        [delegate requestDidTimeout:self.request];
+    }
+}
+
+@end
+
+@interface RestDelegateForwarder ()
+
+@property (nonatomic, strong, readwrite) NSMutableArray *targets;
+
+@end
+
+@implementation RestDelegateForwarder
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _targets = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (RestDelegateTarget *)addTargetWithRequest:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate
+{
+    RestDelegateTarget *target = [[RestDelegateTarget alloc] initWithRequest:request delegate:delegate];
+    [self.targets addObject:target];
+    return target;
+}
+
+- (SFNetworkOperation *)sendRequest:(SFRestRequest *)request withRestApi:(SFRestAPI *)restApi
+{
+    objc_setAssociatedObject(request, &kRestDelegateForwarderKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    return [restApi send:request delegate:self];
+}
+
+- (void)finishRequest:(SFRestRequest *)request
+{
+    // Deferred, so the receiver outlives the delegate call in progress.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (objc_getAssociatedObject(request, &kRestDelegateForwarderKey) == self) {
+            objc_setAssociatedObject(request, &kRestDelegateForwarderKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+    });
+}
+
+- (NSArray *)targetsForRequest:(SFRestRequest *)request
+{
+    return [self.targets copy];
+}
+
+#pragma mark - SFRestDelegate
+
+- (void)request:(SFRestRequest *)request didLoadResponse:(id)dataResponse
+{
+    for (RestDelegateTarget *target in [self targetsForRequest:request]) {
+        [target didLoadResponse:dataResponse];
+    }
+    [self finishRequest:request];
+}
+
+- (void)request:(SFRestRequest *)request didFailLoadWithError:(NSError *)error
+{
+    for (RestDelegateTarget *target in [self targetsForRequest:request]) {
+        [target didFailLoadWithError:error];
+    }
+    [self finishRequest:request];
+}
+
+- (void)requestDidCancelLoad:(SFRestRequest *)request
+{
+    for (RestDelegateTarget *target in [self targetsForRequest:request]) {
+        [target didCancelLoad];
+    }
+    [self finishRequest:request];
+}
+
+- (void)requestDidTimeout:(SFRestRequest *)request
+{
+    for (RestDelegateTarget *target in [self targetsForRequest:request]) {
+        [target didTimeout];
+    }
+    [self finishRequest:request];
+}
+
+@end
@@ -39,7 +39,7 @@ class RootVC: UITableViewController, SFRestDelegate {
         
         var sharedInstance = SFRestAPI.sharedInstance()
         var request = sharedInstance.requestForQuery("SELECT Name FROM User LIMIT 10")
-        sharedInstance.send(request, delegate: self)
+        sharedInstance.sendSingleFlight(request, delegate: self)
         
         //Important Swift- Make sure to register table cell for a non storyboard apps like this one
         self.tableView.registerClass(UITableViewCell.self, forCellReuseIdentifier: "Cell")
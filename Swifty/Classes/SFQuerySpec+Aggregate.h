@@ -0,0 +1,59 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <SalesforceSDKCore/SFQuerySpec.h>
+
+/**
+ * Aggregate functions for aggregate query specs.
+ */
+typedef enum {
+    AggregateFunctionCount = 0,
+    AggregateFunctionSum,
+    AggregateFunctionAverage,
+    AggregateFunctionMinimum,
+    AggregateFunctionMaximum
+} AggregateFunction;
+
+/**
+ * Aggregate (SUM/AVG/MIN/MAX/COUNT, optionally grouped) query specs, built as smart SQL over
+ * the soup's index columns so the aggregate is computed by SQLite without loading entries.
+ */
+@interface SFQuerySpec (Aggregate)
+
+/**
+ * Factory method to build an aggregate query spec.  Run it with
+ * -[SFSmartStore queryWithQuerySpec:pageIndex:]: each result row is an array holding the
+ * group value (when grouping) followed by the aggregate value.  Without a group-by path the
+ * query returns a single row.
+ * Note: path and groupByPath must be indexed paths of the soup.
+ * @param soupName The target soup name.
+ * @param function The aggregate function.
+ * @param path The path to aggregate, or nil to count entries with AggregateFunctionCount.
+ * @param groupByPath The path to group on, or nil for a single total.
+ * @param pageSize The page size, i.e. the number of groups per page.
+ * @return A query spec object.
+ */
++ (SFQuerySpec*) newAggregateQuerySpec:(NSString*)soupName withFunction:(AggregateFunction)function withPath:(NSString*)path withGroupByPath:(NSString*)groupByPath withPageSize:(NSUInteger)pageSize;
+
+@end
@@ -0,0 +1,55 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "SFQuerySpec+Aggregate.h"
+
+@implementation SFQuerySpec (Aggregate)
+
++ (SFQuerySpec*) newAggregateQuerySpec:(NSString*)soupName withFunction:(AggregateFunction)function withPath:(NSString*)path withGroupByPath:(NSString*)groupByPath withPageSize:(NSUInteger)pageSize
+{
+    NSString *functionName;
+    switch (function) {
+        case AggregateFunctionSum:     functionName = @"SUM"; break;
+        case AggregateFunctionAverage: functionName = @"AVG"; break;
+        case AggregateFunctionMinimum: functionName = @"MIN"; break;
+        case AggregateFunctionMaximum: functionName = @"MAX"; break;
+        default:                       functionName = @"COUNT"; break;
+    }
+    
+    // Smart SQL maps {soup:path} to the index column for path, so only the index is read.
+    NSString *argument = (path != nil ? [NSString stringWithFormat:@"{%@:%@}", soupName, path] : @"*");
+    NSString *aggregate = [NSString stringWithFormat:@"%@(%@)", functionName, argument];
+    NSString *smartSql;
+    if (groupByPath != nil) {
+        NSString *group = [NSString stringWithFormat:@"{%@:%@}", soupName, groupByPath];
+        smartSql = [NSString stringWithFormat:@"SELECT %@, %@ FROM {%@} GROUP BY %@ ORDER BY %@",
+                    group, aggregate, soupName, group, group];
+    } else {
+        smartSql = [NSString stringWithFormat:@"SELECT %@ FROM {%@}", aggregate, soupName];
+    }
+    
+    return [SFQuerySpec newSmartQuerySpec:smartSql withPageSize:pageSize];
+}
+
+@end
@@ -0,0 +1,81 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <SalesforceNativeSDK/SFRestAPI.h>
+
+/**
+ * The maximum number of subrequests the composite batch resource accepts in one call.
+ */
+extern NSUInteger const kRestBatchMaximumSubrequests;
+
+@interface SFRestAPI (Batch)
+
+/**
+ * Sends several requests through the composite batch resource, in as few HTTP calls as
+ * possible (one per kRestBatchMaximumSubrequests requests).  Each request's result is
+ * routed to that request's own `delegate`: 2xx results through `request:didLoadResponse:`,
+ * others through `request:didFailLoadWithError:` with the HTTP status as the error code and
+ * the server's error list under the "errors" key of the user info.  If a whole batch call
+ * fails, times out or is cancelled, every request in it is notified accordingly.
+ * The composite batch resource needs `apiVersion` v34.0 or later, and the requests must have
+ * been built with that same version; otherwise every request fails without being sent.
+ * Subrequests can't carry file attachments.
+ * @param requests the SFRestRequests to send, with their delegates already set
+ * @param haltOnError whether the server should skip the rest of a batch after a failed subrequest
+ */
+- (void)sendBatch:(NSArray *)requests haltOnError:(BOOL)haltOnError;
+
+@end
+
+/**
+ * Groups requests enqueued within a short window into composite batch calls.
+ */
+@interface RestRequestCoalescer : NSObject
+
+/**
+ * How long to wait after the first request of a group before sending it.
+ */
+@property (nonatomic, readonly) NSTimeInterval window;
+
+/**
+ * @param restApi the SFRestAPI instance to send the batches through
+ * @param window how long to wait after the first request of a group before sending it
+ */
+- (id)initWithRestApi:(SFRestAPI *)restApi window:(NSTimeInterval)window;
+
+/**
+ * Adds a request to the current group.  The group is sent when the window expires, or right
+ * away once it holds kRestBatchMaximumSubrequests requests.
+ * @param request the SFRestRequest to send
+ * @param delegate the delegate to notify of the request status
+ */
+- (void)enqueue:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate;
+
+/**
+ * Sends the current group immediately.
+ */
+- (void)flush;
+
+@end
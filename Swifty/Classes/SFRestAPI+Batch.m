@@ -0,0 +1,291 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "SFRestAPI+Batch.h"
+#import "RestDelegateForwarder.h"
+
+NSUInteger const kRestBatchMaximumSubrequests = 25;
+
+static double const kBatchMinimumApiVersion = 34.0;
+
+@interface SFRestAPI (BatchPrivate)
+
++ (NSError *)batchErrorWithCode:(NSInteger)code description:(NSString *)description errors:(id)errors;
+
+@end
+
+/**
+ * Delegate of one composite batch call; its targets are the subrequests, in batch order,
+ * and each gets its own entry of the batch's results.
+ */
+@interface RestBatchRequestDelegate : RestDelegateForwarder
+
+@end
+
+@implementation RestBatchRequestDelegate
+
+- (void)request:(SFRestRequest *)request didLoadResponse:(id)dataResponse
+{
+    NSArray *results = ([dataResponse isKindOfClass:[NSDictionary class]] ? [dataResponse objectForKey:@"results"] : nil);
+    if (![results isKindOfClass:[NSArray class]]) {
+        results = nil;
+    }
+    
+    [[self targetsForRequest:request] enumerateObjectsUsingBlock:^(RestDelegateTarget *target, NSUInteger idx, BOOL *stop) {
+        NSDictionary *result = (idx < [results count] ? [results objectAtIndex:idx] : nil);
+        if (![result isKindOfClass:[NSDictionary class]]) {
+            [target didFailLoadWithError:[SFRestAPI batchErrorWithCode:kSFRestErrorCode
+                                                           description:@"Missing result for batch subrequest"
+                                                                errors:nil]];
+            return;
+        }
+        
+        NSInteger statusCode = [[result objectForKey:@"statusCode"] integerValue];
+        id body = [result objectForKey:@"result"];
+        if (body == [NSNull null]) {
+            body = nil;
+        }
+        if (statusCode >= 200 && statusCode < 300) {
+            [target didLoadResponse:body];
+        } else {
+            [target didFailLoadWithError:[SFRestAPI batchErrorWithCode:statusCode
+                                                           description:@"Batch subrequest failed"
+                                                                errors:body]];
+        }
+    }];
+    [self finishRequest:request];
+}
+
+@end
+
+@implementation SFRestAPI (Batch)
+
+- (void)sendBatch:(NSArray *)requests haltOnError:(BOOL)haltOnError
+{
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self sendBatch:requests haltOnError:haltOnError];
+        });
+        return;
+    }
+    
+    BOOL versionSupported = ([self.apiVersion hasPrefix:@"v"] &&
+                             [[self.apiVersion substringFromIndex:1] doubleValue] >= kBatchMinimumApiVersion);
+    NSMutableArray *subrequests = [NSMutableArray arrayWithCapacity:kRestBatchMaximumSubrequests];
+    NSMutableArray *batchRequests = [NSMutableArray arrayWithCapacity:kRestBatchMaximumSubrequests];
+    for (SFRestRequest *request in requests) {
+        NSDictionary *batchRequest = (versionSupported ? [self batchRequestForRequest:request] : nil);
+        if (batchRequest == nil) {
+            NSString *description = [NSString stringWithFormat:@"Request %@ can't be sent in a composite batch with API version %@",
+                                     request.path, self.apiVersion];
+            [self failBatchSubrequest:request withError:[[self class] batchErrorWithCode:kSFRestErrorCode description:description errors:nil]];
+            continue;
+        }
+        
+        [subrequests addObject:request];
+        [batchRequests addObject:batchRequest];
+        if ([subrequests count] == kRestBatchMaximumSubrequests) {
+            [self sendBatchRequests:batchRequests forSubrequests:subrequests haltOnError:haltOnError];
+            subrequests = [NSMutableArray arrayWithCapacity:kRestBatchMaximumSubrequests];
+            batchRequests = [NSMutableArray arrayWithCapacity:kRestBatchMaximumSubrequests];
+        }
+    }
+    if ([subrequests count] > 0) {
+        [self sendBatchRequests:batchRequests forSubrequests:subrequests haltOnError:haltOnError];
+    }
+}
+
+#pragma mark - Private methods
+
++ (NSError *)batchErrorWithCode:(NSInteger)code description:(NSString *)description errors:(id)errors
+{
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey];
+    if (errors != nil) {
+        [userInfo setObject:errors forKey:@"errors"];
+    }
+    return [NSError errorWithDomain:kSFRestErrorDomain code:code userInfo:userInfo];
+}
+
+- (void)failBatchSubrequest:(SFRestRequest *)request withError:(NSError *)error
+{
+    // Delivered asynchronously, like any other request outcome.
+    RestDelegateTarget *target = [[RestDelegateTarget alloc] initWithRequest:request delegate:request.delegate];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [target didFailLoadWithError:error];
+    });
+}
+
+- (void)sendBatchRequests:(NSArray *)batchRequests forSubrequests:(NSArray *)subrequests haltOnError:(BOOL)haltOnError
+{
+    NSString *path = [NSString stringWithFormat:@"/%@/composite/batch", self.apiVersion];
+    NSDictionary *body = @{ @"batchRequests": batchRequests, @"haltOnError": @(haltOnError) };
+    SFRestRequest *batchRequest = [SFRestRequest requestWithMethod:SFRestMethodPOST path:path queryParams:body];
+    
+    RestBatchRequestDelegate *batchDelegate = [[RestBatchRequestDelegate alloc] init];
+    for (SFRestRequest *subrequest in subrequests) {
+        [batchDelegate addTargetWithRequest:subrequest delegate:subrequest.delegate];
+    }
+    [batchDelegate sendRequest:batchRequest withRestApi:self];
+}
+
+// Returns the batchRequests entry for a request, or nil if its path isn't for the current API version.
+- (NSDictionary *)batchRequestForRequest:(SFRestRequest *)request
+{
+    if (request.endpoint != nil && ![request.endpoint isEqualToString:kSFDefaultRestEndpoint]) {
+        return nil;
+    }
+    NSString *url = (request.path != nil ? request.path : @"");
+    if ([url hasPrefix:kSFDefaultRestEndpoint]) {
+        url = [url substringFromIndex:[kSFDefaultRestEndpoint length]];
+    }
+    if ([url hasPrefix:@"/"]) {
+        url = [url substringFromIndex:1];
+    }
+    if (![url hasPrefix:[self.apiVersion stringByAppendingString:@"/"]]) {
+        return nil;
+    }
+    
+    NSString *method = [[self class] batchMethodNameForMethod:request.method];
+    NSMutableDictionary *batchRequest = [NSMutableDictionary dictionaryWithObject:method forKey:@"method"];
+    BOOL hasBody = (request.method == SFRestMethodPOST || request.method == SFRestMethodPUT || request.method == SFRestMethodPATCH);
+    if (hasBody) {
+        if (request.queryParams != nil) {
+            [batchRequest setObject:request.queryParams forKey:@"richInput"];
+        }
+    } else if ([request.queryParams count] > 0) {
+        url = [url stringByAppendingFormat:@"?%@", [[self class] batchQueryStringForParams:request.queryParams]];
+    }
+    [batchRequest setObject:url forKey:@"url"];
+    return batchRequest;
+}
+
++ (NSString *)batchMethodNameForMethod:(SFRestMethod)method
+{
+    switch (method) {
+        case SFRestMethodPOST:   return @"POST";
+        case SFRestMethodPUT:    return @"PUT";
+        case SFRestMethodDELETE: return @"DELETE";
+        case SFRestMethodHEAD:   return @"HEAD";
+        case SFRestMethodPATCH:  return @"PATCH";
+        case SFRestMethodGET:
+        default:                 return @"GET";
+    }
+}
+
++ (NSString *)batchQueryStringForParams:(NSDictionary *)params
+{
+    NSMutableCharacterSet *allowed = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
+    [allowed removeCharactersInString:@"&=+?"];
+    NSMutableArray *pairs = [NSMutableArray arrayWithCapacity:[params count]];
+    NSArray *sortedKeys = [[params allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    for (id key in sortedKeys) {
+        NSString *name = [[key description] stringByAddingPercentEncodingWithAllowedCharacters:allowed];
+        NSString *value = [[[params objectForKey:key] description] stringByAddingPercentEncodingWithAllowedCharacters:allowed];
+        [pairs addObject:[NSString stringWithFormat:@"%@=%@", name, value]];
+    }
+    return [pairs componentsJoinedByString:@"&"];
+}
+
+@end
+
+@interface RestRequestCoalescer ()
+
+@property (nonatomic, strong) SFRestAPI *restApi;
+@property (nonatomic, assign) NSTimeInterval window;
+
+/**
+ * Requests waiting for the current window to expire.  Guarded by @synchronized(self).
+ */
+@property (nonatomic, strong) NSMutableArray *pendingRequests;
+
+/**
+ * Incremented whenever a group is sent, so a stale window timer doesn't send the next group early.
+ */
+@property (nonatomic, assign) NSUInteger generation;
+
+@end
+
+@implementation RestRequestCoalescer
+
+- (id)initWithRestApi:(SFRestAPI *)restApi window:(NSTimeInterval)window
+{
+    self = [super init];
+    if (self) {
+        _restApi = restApi;
+        _window = window;
+        _pendingRequests = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)enqueue:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate
+{
+    request.delegate = delegate;
+    
+    BOOL isFull = NO;
+    BOOL startsGroup = NO;
+    NSUInteger generation = 0;
+    @synchronized(self) {
+        [self.pendingRequests addObject:request];
+        startsGroup = ([self.pendingRequests count] == 1);
+        isFull = ([self.pendingRequests count] >= kRestBatchMaximumSubrequests);
+        generation = self.generation;
+    }
+    
+    if (isFull) {
+        [self flush];
+    } else if (startsGroup) {
+        __weak RestRequestCoalescer *weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.window * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [weakSelf flushGeneration:generation];
+        });
+    }
+}
+
+- (void)flush
+{
+    NSArray *requests = nil;
+    @synchronized(self) {
+        requests = [self.pendingRequests copy];
+        [self.pendingRequests removeAllObjects];
+        self.generation++;
+    }
+    if ([requests count] > 0) {
+        [self.restApi sendBatch:requests haltOnError:NO];
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)flushGeneration:(NSUInteger)generation
+{
+    @synchronized(self) {
+        if (generation != self.generation) {
+            return;
+        }
+    }
+    [self flush];
+}
+
+@end
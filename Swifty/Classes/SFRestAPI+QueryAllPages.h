@@ -0,0 +1,70 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <SalesforceNativeSDK/SFRestAPI+Blocks.h>
+
+// Block types
+typedef void (^RestRecordsBlock) (NSArray *records);
+typedef void (^RestQueryAllPagesCompleteBlock) (NSUInteger totalSize);
+
+/**
+ * Handle on a running `performSOQLQueryAllPages:` call.
+ */
+@interface RestQueryAllPagesFetcher : NSObject
+
+/**
+ * Stops the run: the page request in flight is cancelled, no further page is requested,
+ * and none of the run's blocks are executed afterwards (a `recordsBlock` call already
+ * executing is allowed to finish).
+ */
+- (void)cancel;
+
+@end
+
+@interface SFRestAPI (QueryAllPages)
+
+/**
+ * Executes a SOQL query and follows `nextRecordsUrl` until every page has been fetched.
+ * The request for the next page is sent as soon as the current page arrives, so the
+ * round trip overlaps with the work done in `recordsBlock`.
+ * All three blocks are executed serially on one private queue, so `failBlock` and
+ * `completeBlock` only run once every page delivered before them has been consumed.
+ * @param query the SOQL query to be executed
+ * @param prefetchDepth the number of pages that may be fetched ahead of `recordsBlock`.
+ *        Once that many pages are waiting, no further page is requested until one has been
+ *        consumed. Pass 0 to fetch each page only after the previous one has been consumed.
+ * @param recordsBlock the block to be executed with the records of each page, in page order
+ *        (eg to upsert them into a SmartStore soup)
+ * @param failBlock the block to be executed when any page request fails (timeout or error)
+ * @param completeBlock the block to be executed after the last page has been consumed
+ * @return a handle that can be used to cancel the run
+ */
+- (RestQueryAllPagesFetcher *) performSOQLQueryAllPages:(NSString *)query
+                                          prefetchDepth:(NSUInteger)prefetchDepth
+                                           recordsBlock:(RestRecordsBlock)recordsBlock
+                                              failBlock:(SFRestFailBlock)failBlock
+                                          completeBlock:(RestQueryAllPagesCompleteBlock)completeBlock;
+
+@end
@@ -0,0 +1,209 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "SFRestAPI+QueryAllPages.h"
+
+/**
+ * Drives one query-all-pages run. Page requests are chained through `nextRecordsUrl`,
+ * so at most one request is in flight; pipelining comes from sending it before the
+ * previous page has been consumed.
+ */
+@interface RestQueryAllPagesFetcher ()
+
+@property (nonatomic, strong) SFRestAPI *restApi;
+@property (nonatomic, assign) NSUInteger prefetchDepth;
+@property (nonatomic, copy) RestRecordsBlock recordsBlock;
+@property (nonatomic, copy) SFRestFailBlock failBlock;
+@property (nonatomic, copy) RestQueryAllPagesCompleteBlock completeBlock;
+
+/**
+ * Serializes access to the paging state below.
+ */
+@property (nonatomic, strong) dispatch_queue_t stateQueue;
+
+/**
+ * Serial queue on which the caller's blocks are run, so pages are consumed in order
+ * and failure/completion are reported after them.
+ */
+@property (nonatomic, strong) dispatch_queue_t consumerQueue;
+
+@property (nonatomic, strong) NSString *nextRecordsUrl;
+@property (nonatomic, assign) NSUInteger pendingPages;
+@property (nonatomic, assign) BOOL fetchInFlight;
+@property (nonatomic, assign) BOOL failed;
+
+/**
+ * Set from any queue by -cancel; checked before each of the caller's blocks runs.
+ */
+@property (atomic, assign) BOOL cancelled;
+
+/**
+ * The page request in flight. Only touched on the main queue.
+ */
+@property (nonatomic, strong) SFRestRequest *currentRequest;
+
+- (void)sendPageRequest:(SFRestRequest *)request;
+
+@end
+
+@implementation RestQueryAllPagesFetcher
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _stateQueue = dispatch_queue_create("com.salesforce.swifty.queryAllPages.state", DISPATCH_QUEUE_SERIAL);
+        _consumerQueue = dispatch_queue_create("com.salesforce.swifty.queryAllPages.consumer", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)cancel
+{
+    self.cancelled = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self.currentRequest cancel];
+        self.currentRequest = nil;
+    });
+}
+
+// Always called on stateQueue.  The request itself is sent from the main queue, the only
+// queue the app uses SFRestAPI from (see RestDelegateForwarder.h).
+- (void)sendPageRequest:(SFRestRequest *)request
+{
+    self.fetchInFlight = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (self.cancelled) {
+            return;
+        }
+        self.currentRequest = request;
+        [self.restApi sendRESTRequest:request failBlock:^(NSError *e) {
+            dispatch_async(self.stateQueue, ^{
+                [self didFailPageWithError:e];
+            });
+        } completeBlock:^(NSDictionary *response) {
+            dispatch_async(self.stateQueue, ^{
+                [self didLoadPage:response];
+            });
+        }];
+    });
+}
+
+#pragma mark - Private methods
+
+// Always called on stateQueue.
+- (void)didFailPageWithError:(NSError *)error
+{
+    self.fetchInFlight = NO;
+    if (self.failed || self.cancelled) {
+        return;
+    }
+    self.failed = YES;
+    
+    // Queued behind any pages still waiting on recordsBlock.
+    dispatch_async(self.consumerQueue, ^{
+        if (!self.cancelled && self.failBlock) {
+            self.failBlock(error);
+        }
+    });
+}
+
+// Always called on stateQueue.
+- (void)didLoadPage:(NSDictionary *)response
+{
+    self.fetchInFlight = NO;
+    if (self.failed || self.cancelled) {
+        return;
+    }
+    
+    NSArray *records = [response objectForKey:@"records"];
+    NSUInteger totalSize = [[response objectForKey:@"totalSize"] unsignedIntegerValue];
+    NSString *nextRecordsUrl = [response objectForKey:@"nextRecordsUrl"];
+    BOOL isLastPage = [[response objectForKey:@"done"] boolValue] || ![nextRecordsUrl isKindOfClass:[NSString class]];
+    self.nextRecordsUrl = (isLastPage ? nil : nextRecordsUrl);
+    
+    // Request the next page before handing this one off, so the round trip overlaps with the consumer.
+    self.pendingPages++;
+    [self fetchNextPageIfAllowed];
+    
+    dispatch_async(self.consumerQueue, ^{
+        if (!self.cancelled && self.recordsBlock) {
+            self.recordsBlock(records);
+        }
+        if (isLastPage && !self.cancelled && self.completeBlock) {
+            self.completeBlock(totalSize);
+        }
+        dispatch_async(self.stateQueue, ^{
+            self.pendingPages--;
+            [self fetchNextPageIfAllowed];
+        });
+    });
+}
+
+// Always called on stateQueue.  Backpressure: holds the next request while more than
+// prefetchDepth pages are waiting on the consumer (the page being consumed counts as one).
+- (void)fetchNextPageIfAllowed
+{
+    if (self.failed || self.cancelled || self.fetchInFlight || self.nextRecordsUrl == nil || self.pendingPages > self.prefetchDepth) {
+        return;
+    }
+    
+    // nextRecordsUrl is absolute from the instance root, eg "/services/data/v29.0/query/01gD0000002HU6KIAW-2000",
+    // while request paths are relative to the endpoint.
+    NSString *path = self.nextRecordsUrl;
+    if ([path hasPrefix:kSFDefaultRestEndpoint]) {
+        path = [path substringFromIndex:[kSFDefaultRestEndpoint length]];
+    }
+    self.nextRecordsUrl = nil;
+    
+    SFRestRequest *request = [SFRestRequest requestWithMethod:SFRestMethodGET path:path queryParams:nil];
+    [self sendPageRequest:request];
+}
+
+@end
+
+@implementation SFRestAPI (QueryAllPages)
+
+- (RestQueryAllPagesFetcher *) performSOQLQueryAllPages:(NSString *)query
+                                          prefetchDepth:(NSUInteger)prefetchDepth
+                                           recordsBlock:(RestRecordsBlock)recordsBlock
+                                              failBlock:(SFRestFailBlock)failBlock
+                                          completeBlock:(RestQueryAllPagesCompleteBlock)completeBlock
+{
+    // The fetcher is kept alive by the blocks of its in-flight request and queued pages.
+    RestQueryAllPagesFetcher *fetcher = [[RestQueryAllPagesFetcher alloc] init];
+    fetcher.restApi = self;
+    fetcher.prefetchDepth = prefetchDepth;
+    fetcher.recordsBlock = recordsBlock;
+    fetcher.failBlock = failBlock;
+    fetcher.completeBlock = completeBlock;
+    
+    SFRestRequest *request = [self requestForQuery:query];
+    dispatch_async(fetcher.stateQueue, ^{
+        [fetcher sendPageRequest:request];
+    });
+    return fetcher;
+}
+
+@end
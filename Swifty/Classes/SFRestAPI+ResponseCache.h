@@ -0,0 +1,91 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <SalesforceNativeSDK/SFRestAPI.h>
+
+/**
+ * How `sendCached:cachePolicy:delegate:` uses the response cache.
+ */
+typedef enum RestCachePolicy {
+    /** Always load from the server and leave the cache untouched. */
+    RestCachePolicyIgnoreCache = 0,
+    /** Revalidate any cached response with If-None-Match/If-Modified-Since, serving it on 304 Not Modified. */
+    RestCachePolicyRevalidate,
+    /** Serve any cached response without contacting the server; load and cache it otherwise. */
+    RestCachePolicyReturnCacheElseLoad,
+} RestCachePolicy;
+
+/**
+ * Encrypted, size-bounded on-disk cache of GET responses, kept per user.
+ */
+@interface RestResponseCache : NSObject
+
+/**
+ * @return The cache used by `sendCached:cachePolicy:delegate:`.
+ */
++ (instancetype)sharedCache;
+
+/**
+ * Upper bound on the size of the cached responses on disk.  Least recently used responses
+ * are evicted past it.  Defaults to 10MB.
+ */
+@property (atomic, assign) unsigned long long maximumSizeInBytes;
+
+/**
+ * The number of responses served from the cache, whether directly or after a 304.
+ */
+@property (atomic, readonly) NSUInteger hitCount;
+
+/**
+ * The number of cacheable requests that had to download a full response.
+ */
+@property (atomic, readonly) NSUInteger missCount;
+
+/**
+ * The number of response bytes served from the cache instead of being downloaded.
+ */
+@property (atomic, readonly) unsigned long long bytesSaved;
+
+/**
+ * Removes every cached response of the current user.
+ */
+- (void)removeAllResponses;
+
+@end
+
+@interface SFRestAPI (ResponseCache)
+
+/**
+ * Sends a request like `send:delegate:`, serving GET responses from the RestResponseCache
+ * according to `cachePolicy`.  Requests with any other method are sent as usual.
+ * Returns immediately: the cache is read, decrypted and parsed in the background, and the
+ * request is then sent, or the cached response delivered, on the main queue.
+ * @param request the SFRestRequest to be sent
+ * @param cachePolicy how the cache is used for this request
+ * @param delegate the delegate to notify of the request status
+ */
+- (void)sendCached:(SFRestRequest *)request cachePolicy:(RestCachePolicy)cachePolicy delegate:(id<SFRestDelegate>)delegate;
+
+@end
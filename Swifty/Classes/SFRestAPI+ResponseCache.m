@@ -0,0 +1,360 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <CommonCrypto/CommonCryptor.h>
+#import <SalesforceCommonUtils/NSData+SFAdditions.h>
+#import <SalesforceSDKCore/SFDirectoryManager.h>
+#import <SalesforceSecurity/SFKeyStoreManager.h>
+#import <SalesforceSecurity/SFSDKCryptoUtils.h>
+#import "SFRestAPI+ResponseCache.h"
+#import "SFRestRequest+RequestKey.h"
+#import "RestDelegateForwarder.h"
+
+static NSString * const kRestResponseCacheKeyLabel = @"com.salesforce.swifty.restResponseCache";
+static NSString * const kRestResponseCacheDirectory = @"RestResponseCache";
+static unsigned long long const kRestResponseCacheDefaultMaximumSize = 10 * 1024 * 1024;
+
+static NSString * const kIfNoneMatchHeaderName = @"If-None-Match";
+static NSString * const kIfModifiedSinceHeaderName = @"If-Modified-Since";
+
+static NSString * const kEntryBodyKey = @"body";
+static NSString * const kEntryETagKey = @"etag";
+static NSString * const kEntryLastModifiedKey = @"lastModified";
+
+@interface RestResponseCache ()
+
+@property (atomic, assign) NSUInteger hitCount;
+@property (atomic, assign) NSUInteger missCount;
+@property (atomic, assign) unsigned long long bytesSaved;
+
+/**
+ * Serializes all disk access.
+ */
+@property (nonatomic, strong) dispatch_queue_t ioQueue;
+
+- (void)loadEntryForKey:(NSString *)key completion:(void (^)(NSDictionary *entry))completion;
+- (void)storeEntry:(NSDictionary *)entry forKey:(NSString *)key;
+- (void)recordHitWithByteCount:(NSUInteger)byteCount;
+- (void)recordMiss;
+
+@end
+
+/**
+ * Delegate of a cacheable request, whose only target is the caller: serves the cached
+ * response on 304 and stores fresh responses.
+ */
+@interface RestResponseCacheDelegate : RestDelegateForwarder
+
+@property (nonatomic, strong) NSString *cacheKey;
+@property (nonatomic, strong) NSDictionary *cachedEntry;
+
+/**
+ * The cached entry's body as the caller's delegate expects it, parsed on the cache's queue.
+ */
+@property (nonatomic, strong) id cachedResponse;
+
+@end
+
+#pragma mark - Helpers
+
+static id ResponseCacheHeaderValue(NSDictionary *headers, NSString *name)
+{
+    for (NSString *headerName in headers) {
+        if ([headerName caseInsensitiveCompare:name] == NSOrderedSame) {
+            return [headers objectForKey:headerName];
+        }
+    }
+    return nil;
+}
+
+// Turns a cached body back into what the request's delegate expects, or nil if it can't be parsed.
+static id ResponseCacheResponseFromEntry(NSDictionary *entry, SFRestRequest *request)
+{
+    NSData *body = [entry objectForKey:kEntryBodyKey];
+    if (!request.parseResponse) {
+        return body;
+    }
+    return [NSJSONSerialization JSONObjectWithData:body options:0 error:NULL];
+}
+
+// The validators are set by sendCached itself, so they never make two requests different.
+static NSString *ResponseCacheKeyForRequest(SFRestRequest *request)
+{
+    NSString *key = [request requestKeyIgnoringHeaders:@[ kIfNoneMatchHeaderName, kIfModifiedSinceHeaderName ]];
+    return [[key dataUsingEncoding:NSUTF8StringEncoding] md5];
+}
+
+@implementation RestResponseCache
+
++ (instancetype)sharedCache
+{
+    static RestResponseCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[RestResponseCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _maximumSizeInBytes = kRestResponseCacheDefaultMaximumSize;
+        _ioQueue = dispatch_queue_create("com.salesforce.swifty.restResponseCache", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)removeAllResponses
+{
+    dispatch_async(self.ioQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtPath:[self cacheDirectory] error:NULL];
+    });
+}
+
+// Calls completion on ioQueue, with nil if there is no readable entry.
+- (void)loadEntryForKey:(NSString *)key completion:(void (^)(NSDictionary *entry))completion
+{
+    dispatch_async(self.ioQueue, ^{
+        NSString *path = [[self cacheDirectory] stringByAppendingPathComponent:key];
+        NSData *fileData = [NSData dataWithContentsOfFile:path];
+        if ([fileData length] <= kCCBlockSizeAES128) {
+            completion(nil);
+            return;
+        }
+        
+        // Each file is the random IV followed by the encrypted, archived entry.
+        NSData *iv = [fileData subdataWithRange:NSMakeRange(0, kCCBlockSizeAES128)];
+        NSData *encrypted = [fileData subdataWithRange:NSMakeRange(kCCBlockSizeAES128, [fileData length] - kCCBlockSizeAES128)];
+        NSData *archived = [SFSDKCryptoUtils aes256DecryptData:encrypted withKey:[self encryptionKey].key iv:iv];
+        NSDictionary *entry = nil;
+        @try {
+            entry = [NSKeyedUnarchiver unarchiveObjectWithData:archived];
+        }
+        @catch (NSException *exception) {
+            entry = nil;
+        }
+        if (![entry isKindOfClass:[NSDictionary class]] || ![[entry objectForKey:kEntryBodyKey] isKindOfClass:[NSData class]]) {
+            // Unreadable, eg written under a key that has since been reset.
+            [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+            completion(nil);
+            return;
+        }
+        
+        // The modification date doubles as the last-use time for eviction.
+        [[NSFileManager defaultManager] setAttributes:@{ NSFileModificationDate: [NSDate date] } ofItemAtPath:path error:NULL];
+        completion(entry);
+    });
+}
+
+- (void)storeEntry:(NSDictionary *)entry forKey:(NSString *)key
+{
+    dispatch_async(self.ioQueue, ^{
+        NSString *directory = [self cacheDirectory];
+        if (![SFDirectoryManager ensureDirectoryExists:directory error:NULL]) {
+            return;
+        }
+        
+        NSData *archived = [NSKeyedArchiver archivedDataWithRootObject:entry];
+        NSData *iv = [SFSDKCryptoUtils randomByteDataWithLength:kCCBlockSizeAES128];
+        NSData *encrypted = [SFSDKCryptoUtils aes256EncryptData:archived withKey:[self encryptionKey].key iv:iv];
+        if (encrypted == nil) {
+            return;
+        }
+        NSMutableData *fileData = [NSMutableData dataWithData:iv];
+        [fileData appendData:encrypted];
+        [fileData writeToFile:[directory stringByAppendingPathComponent:key] atomically:YES];
+        
+        [self evictToMaximumSize];
+    });
+}
+
+- (void)recordHitWithByteCount:(NSUInteger)byteCount
+{
+    @synchronized(self) {
+        self.hitCount++;
+        self.bytesSaved += byteCount;
+    }
+}
+
+- (void)recordMiss
+{
+    @synchronized(self) {
+        self.missCount++;
+    }
+}
+
+#pragma mark - Private methods
+
+// Per user, so one user's cached responses are never served to another.
+- (NSString *)cacheDirectory
+{
+    return [[SFDirectoryManager sharedManager] directoryOfCurrentUserForType:NSCachesDirectory
+                                                                   components:@[ kRestResponseCacheDirectory ]];
+}
+
+- (SFEncryptionKey *)encryptionKey
+{
+    return [[SFKeyStoreManager sharedInstance] retrieveKeyWithLabel:kRestResponseCacheKeyLabel autoCreate:YES];
+}
+
+// Always called on ioQueue.
+- (void)evictToMaximumSize
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSURL *directoryUrl = [NSURL fileURLWithPath:[self cacheDirectory] isDirectory:YES];
+    NSArray *resourceKeys = @[ NSURLFileSizeKey, NSURLContentModificationDateKey ];
+    NSArray *fileUrls = [fileManager contentsOfDirectoryAtURL:directoryUrl includingPropertiesForKeys:resourceKeys options:0 error:NULL];
+    
+    unsigned long long totalSize = 0;
+    NSMutableArray *files = [NSMutableArray arrayWithCapacity:[fileUrls count]];
+    for (NSURL *fileUrl in fileUrls) {
+        NSDictionary *values = [fileUrl resourceValuesForKeys:resourceKeys error:NULL];
+        if (values == nil) {
+            continue;
+        }
+        totalSize += [[values objectForKey:NSURLFileSizeKey] unsignedLongLongValue];
+        [files addObject:@{ @"url": fileUrl, @"values": values }];
+    }
+    if (totalSize <= self.maximumSizeInBytes) {
+        return;
+    }
+    
+    [files sortUsingComparator:^NSComparisonResult(NSDictionary *file1, NSDictionary *file2) {
+        NSDate *date1 = [[file1 objectForKey:@"values"] objectForKey:NSURLContentModificationDateKey];
+        NSDate *date2 = [[file2 objectForKey:@"values"] objectForKey:NSURLContentModificationDateKey];
+        return [date1 compare:date2];
+    }];
+    for (NSDictionary *file in files) {
+        if (totalSize <= self.maximumSizeInBytes) {
+            break;
+        }
+        if ([fileManager removeItemAtURL:[file objectForKey:@"url"] error:NULL]) {
+            totalSize -= [[[file objectForKey:@"values"] objectForKey:NSURLFileSizeKey] unsignedLongLongValue];
+        }
+    }
+}
+
+@end
+
+@implementation RestResponseCacheDelegate
+
+- (void)request:(SFRestRequest *)request didLoadResponse:(id)dataResponse
+{
+    SFNetworkOperation *operation = request.networkOperation;
+    if (self.cachedEntry != nil && operation.statusCode == 304) {
+        [self serveCachedEntryForRequest:request];
+        return;
+    }
+    
+    [[RestResponseCache sharedCache] recordMiss];
+    NSData *body = [operation responseAsData];
+    if ([body length] > 0) {
+        NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithObject:body forKey:kEntryBodyKey];
+        NSString *etag = ResponseCacheHeaderValue(operation.responseHeaders, @"ETag");
+        NSString *lastModified = ResponseCacheHeaderValue(operation.responseHeaders, @"Last-Modified");
+        if (etag != nil) {
+            [entry setObject:etag forKey:kEntryETagKey];
+        }
+        if (lastModified != nil) {
+            [entry setObject:lastModified forKey:kEntryLastModifiedKey];
+        }
+        [[RestResponseCache sharedCache] storeEntry:entry forKey:self.cacheKey];
+    }
+    
+    [super request:request didLoadResponse:dataResponse];
+}
+
+- (void)request:(SFRestRequest *)request didFailLoadWithError:(NSError *)error
+{
+    // A 304 carries no body, so it may surface as a failure rather than a load.
+    if (self.cachedEntry != nil && request.networkOperation.statusCode == 304) {
+        [self serveCachedEntryForRequest:request];
+        return;
+    }
+    
+    [super request:request didFailLoadWithError:error];
+}
+
+#pragma mark - Private methods
+
+- (void)serveCachedEntryForRequest:(SFRestRequest *)request
+{
+    id response = self.cachedResponse;
+    if (response == nil) {
+        [super request:request didFailLoadWithError:[NSError errorWithDomain:kSFRestErrorDomain
+                                                                         code:kSFRestErrorCode
+                                                                     userInfo:@{ NSLocalizedDescriptionKey: @"Cached response could not be parsed" }]];
+        return;
+    }
+    
+    [[RestResponseCache sharedCache] recordHitWithByteCount:[[self.cachedEntry objectForKey:kEntryBodyKey] length]];
+    [super request:request didLoadResponse:response];
+}
+
+@end
+
+@implementation SFRestAPI (ResponseCache)
+
+- (void)sendCached:(SFRestRequest *)request cachePolicy:(RestCachePolicy)cachePolicy delegate:(id<SFRestDelegate>)delegate
+{
+    if (request.method != SFRestMethodGET || cachePolicy == RestCachePolicyIgnoreCache) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self send:request delegate:delegate];
+        });
+        return;
+    }
+    
+    RestResponseCache *cache = [RestResponseCache sharedCache];
+    NSString *cacheKey = ResponseCacheKeyForRequest(request);
+    [cache loadEntryForKey:cacheKey completion:^(NSDictionary *entry) {
+        // Parsed here rather than on the main queue, whether it is served now or after a 304.
+        // An entry that no longer parses is treated as missing.
+        id cachedResponse = (entry != nil ? ResponseCacheResponseFromEntry(entry, request) : nil);
+        if (cachedResponse == nil) {
+            entry = nil;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (cachedResponse != nil && cachePolicy == RestCachePolicyReturnCacheElseLoad) {
+                [cache recordHitWithByteCount:[[entry objectForKey:kEntryBodyKey] length]];
+                [[[RestDelegateTarget alloc] initWithRequest:request delegate:delegate] didLoadResponse:cachedResponse];
+                return;
+            }
+            
+            // Validators are always (re)set, so a resent request never carries stale ones.
+            [request setHeaderValue:[entry objectForKey:kEntryETagKey] forHeaderName:kIfNoneMatchHeaderName];
+            [request setHeaderValue:[entry objectForKey:kEntryLastModifiedKey] forHeaderName:kIfModifiedSinceHeaderName];
+            
+            RestResponseCacheDelegate *cacheDelegate = [[RestResponseCacheDelegate alloc] init];
+            [cacheDelegate addTargetWithRequest:request delegate:delegate];
+            cacheDelegate.cacheKey = cacheKey;
+            cacheDelegate.cachedEntry = entry;
+            cacheDelegate.cachedResponse = cachedResponse;
+            [cacheDelegate sendRequest:request withRestApi:self];
+        });
+    }];
+}
+
+@end
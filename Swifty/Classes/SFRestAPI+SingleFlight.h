@@ -0,0 +1,59 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <SalesforceNativeSDK/SFRestAPI.h>
+
+@interface SFRestAPI (SingleFlight)
+
+/**
+ * The number of requests that were joined to an identical in-flight request
+ * by `sendSingleFlight:delegate:` instead of going to the network.
+ */
+@property (nonatomic, readonly) NSUInteger coalescedRequestCount;
+
+/**
+ * Sends a request like `send:delegate:`, except that a GET identical to one already in flight
+ * (same endpoint, path, query parameters, headers and parseResponse) joins that request
+ * instead of issuing its own. When the shared request finishes, every joined delegate is
+ * notified with its own request object and the same response.
+ * Requests with any other method are sent as usual.
+ * The network call is made with an internal copy of the request, so a single-flight request
+ * must be cancelled with `cancelSingleFlight:` rather than `-[SFRestRequest cancel]`.
+ * Like `send:delegate:`, this runs on the main thread; calls from other threads wait for it.
+ * @param request the SFRestRequest to be sent
+ * @param delegate the delegate to notify of the request status
+ * @return the SFNetworkOperation carrying the request, shared for joined requests
+ */
+- (SFNetworkOperation *)sendSingleFlight:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate;
+
+/**
+ * Cancels a request sent with `sendSingleFlight:delegate:`.  Its delegate is notified with
+ * `requestDidCancelLoad:`; the shared network operation is only cancelled once no other
+ * request is waiting on it.  The cancellation happens asynchronously on the main queue.
+ * @param request the SFRestRequest previously passed to `sendSingleFlight:delegate:`
+ */
+- (void)cancelSingleFlight:(SFRestRequest *)request;
+
+@end
@@ -0,0 +1,188 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <objc/runtime.h>
+#import "SFRestAPI+SingleFlight.h"
+#import "SFRestRequest+RequestKey.h"
+#import "RestDelegateForwarder.h"
+
+static char kSingleFlightGroupsKey;
+static char kCoalescedRequestCountKey;
+
+/**
+ * Delegate of the request actually sent; its targets are the requests waiting on it.
+ * The targets are guarded by @synchronized on the SFRestAPI instance.
+ */
+@interface RestSingleFlightGroup : RestDelegateForwarder
+
+@property (nonatomic, strong) NSString *key;
+
+/**
+ * Internal copy of the first request, so no caller can cancel it for the others.
+ * It keeps the group alive while in flight.
+ */
+@property (nonatomic, weak) SFRestRequest *sharedRequest;
+@property (nonatomic, strong) SFNetworkOperation *networkOperation;
+@property (nonatomic, weak) SFRestAPI *restApi;
+
+@end
+
+@interface SFRestAPI (SingleFlightPrivate)
+
+- (NSArray *)finishSingleFlightGroup:(RestSingleFlightGroup *)group;
+
+@end
+
+@implementation RestSingleFlightGroup
+
+- (NSArray *)targetsForRequest:(SFRestRequest *)request
+{
+    return [self.restApi finishSingleFlightGroup:self];
+}
+
+@end
+
+@implementation SFRestAPI (SingleFlight)
+
+- (NSUInteger)coalescedRequestCount
+{
+    @synchronized(self) {
+        return [objc_getAssociatedObject(self, &kCoalescedRequestCountKey) unsignedIntegerValue];
+    }
+}
+
+- (SFNetworkOperation *)sendSingleFlight:(SFRestRequest *)request delegate:(id<SFRestDelegate>)delegate
+{
+    if (request.method != SFRestMethodGET) {
+        return [self send:request delegate:delegate];
+    }
+    
+    // Joining and sending happen on the main thread, so a joiner can never observe a group
+    // whose operation has not been assigned yet.
+    if (![NSThread isMainThread]) {
+        __block SFNetworkOperation *operation = nil;
+        dispatch_sync(dispatch_get_main_queue(), ^{
+            operation = [self sendSingleFlight:request delegate:delegate];
+        });
+        return operation;
+    }
+    
+    NSString *key = [request requestKeyIgnoringHeaders:nil];
+    RestSingleFlightGroup *group = nil;
+    SFRestRequest *sharedRequest = nil;
+    @synchronized(self) {
+        NSMutableDictionary *groups = [self singleFlightGroups];
+        RestSingleFlightGroup *existingGroup = [groups objectForKey:key];
+        if (existingGroup != nil) {
+            [existingGroup addTargetWithRequest:request delegate:delegate];
+            NSUInteger count = [objc_getAssociatedObject(self, &kCoalescedRequestCountKey) unsignedIntegerValue];
+            objc_setAssociatedObject(self, &kCoalescedRequestCountKey, @(count + 1), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+            return existingGroup.networkOperation;
+        }
+        
+        sharedRequest = [[self class] singleFlightCopyOfRequest:request];
+        group = [[RestSingleFlightGroup alloc] init];
+        group.key = key;
+        group.sharedRequest = sharedRequest;
+        group.restApi = self;
+        [group addTargetWithRequest:request delegate:delegate];
+        [groups setObject:group forKey:key];
+    }
+    
+    SFNetworkOperation *operation = [group sendRequest:sharedRequest withRestApi:self];
+    @synchronized(self) {
+        group.networkOperation = operation;
+    }
+    return operation;
+}
+
+- (void)cancelSingleFlight:(SFRestRequest *)request
+{
+    // Like sending, cancelling and its delegate call happen on the main queue.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        RestDelegateTarget *cancelledTarget = nil;
+        SFRestRequest *abandonedRequest = nil;
+        @synchronized(self) {
+            NSMutableDictionary *groups = [self singleFlightGroups];
+            RestSingleFlightGroup *group = [groups objectForKey:[request requestKeyIgnoringHeaders:nil]];
+            for (RestDelegateTarget *target in group.targets) {
+                if (target.request == request) {
+                    cancelledTarget = target;
+                    break;
+                }
+            }
+            if (cancelledTarget == nil) {
+                return;
+            }
+            
+            [group.targets removeObject:cancelledTarget];
+            if ([group.targets count] == 0) {
+                // Nobody is left waiting: drop the group so identical requests start afresh.
+                [groups removeObjectForKey:group.key];
+                abandonedRequest = group.sharedRequest;
+            }
+        }
+        
+        [cancelledTarget didCancelLoad];
+        [abandonedRequest cancel];
+    });
+}
+
+#pragma mark - Private methods
+
+// Callers must hold @synchronized(self).
+- (NSMutableDictionary *)singleFlightGroups
+{
+    NSMutableDictionary *groups = objc_getAssociatedObject(self, &kSingleFlightGroupsKey);
+    if (groups == nil) {
+        groups = [NSMutableDictionary dictionary];
+        objc_setAssociatedObject(self, &kSingleFlightGroupsKey, groups, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return groups;
+}
+
+- (NSArray *)finishSingleFlightGroup:(RestSingleFlightGroup *)group
+{
+    @synchronized(self) {
+        // The group may already have been replaced after all of its waiters cancelled.
+        NSMutableDictionary *groups = [self singleFlightGroups];
+        if ([groups objectForKey:group.key] == group) {
+            [groups removeObjectForKey:group.key];
+        }
+        NSArray *targets = [group.targets copy];
+        [group.targets removeAllObjects];
+        return targets;
+    }
+}
+
++ (SFRestRequest *)singleFlightCopyOfRequest:(SFRestRequest *)request
+{
+    SFRestRequest *copy = [SFRestRequest requestWithMethod:request.method path:request.path queryParams:request.queryParams];
+    copy.endpoint = request.endpoint;
+    copy.customHeaders = request.customHeaders;
+    copy.parseResponse = request.parseResponse;
+    return copy;
+}
+
+@end
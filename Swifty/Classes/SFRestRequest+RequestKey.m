@@ -0,0 +1,79 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <SalesforceNativeSDK/SFRestAPI.h>
+#import "SFRestRequest+RequestKey.h"
+
+@implementation SFRestRequest (RequestKey)
+
+- (NSString *)requestKeyIgnoringHeaders:(NSArray *)ignoredHeaderNames
+{
+    // send:delegate: prefixes the endpoint when the path lacks it, so both spellings are the same request.
+    NSString *endpoint = (self.endpoint != nil ? self.endpoint : kSFDefaultRestEndpoint);
+    NSString *path = (self.path != nil ? self.path : @"");
+    if ([endpoint length] > 0 && [path hasPrefix:endpoint]) {
+        path = [path substringFromIndex:[endpoint length]];
+    }
+    if (![path hasPrefix:@"/"]) {
+        path = [@"/" stringByAppendingString:path];
+    }
+    
+    NSMutableDictionary *headers = [NSMutableDictionary dictionaryWithCapacity:[self.customHeaders count]];
+    for (NSString *headerName in self.customHeaders) {
+        BOOL ignored = NO;
+        for (NSString *ignoredHeaderName in ignoredHeaderNames) {
+            if ([headerName caseInsensitiveCompare:ignoredHeaderName] == NSOrderedSame) {
+                ignored = YES;
+                break;
+            }
+        }
+        if (!ignored) {
+            [headers setObject:[self.customHeaders objectForKey:headerName] forKey:headerName];
+        }
+    }
+    
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%@%@|%d", endpoint, path, self.parseResponse];
+    [key appendString:[[self class] requestKeyComponentForDictionary:self.queryParams]];
+    [key appendString:[[self class] requestKeyComponentForDictionary:headers]];
+    return key;
+}
+
+#pragma mark - Private methods
+
+// Names and values are percent-escaped, so one containing a separator can't make two different dictionaries look alike.
++ (NSString *)requestKeyComponentForDictionary:(NSDictionary *)dictionary
+{
+    NSMutableCharacterSet *allowed = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
+    [allowed removeCharactersInString:@"&=+?|"];
+    NSMutableString *component = [NSMutableString stringWithString:@"|"];
+    NSArray *sortedKeys = [[dictionary allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    for (id key in sortedKeys) {
+        NSString *name = [[key description] stringByAddingPercentEncodingWithAllowedCharacters:allowed];
+        NSString *value = [[[dictionary objectForKey:key] description] stringByAddingPercentEncodingWithAllowedCharacters:allowed];
+        [component appendFormat:@"%@=%@&", name, value];
+    }
+    return component;
+}
+
+@end
@@ -0,0 +1,57 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <SalesforceSDKCore/SFSmartStore.h>
+
+/**
+ * The most soup entry IDs retrieved per batch: SQLite's default limit on host parameters
+ * in one statement.
+ */
+extern NSUInteger const kChunkedRetrieveMaximumBatchSize;
+
+/**
+ * Block called with each retrieved batch of soup entries.
+ */
+typedef void (^ChunkedRetrieveBatchBlock)(NSArray *entries);
+
+/**
+ * Retrieval of large soup entry ID lists in bounded batches.
+ */
+@interface SFSmartStore (ChunkedRetrieve)
+
+/**
+ * Retrieves the given soup entries in batches, calling batchBlock with each batch as soon as
+ * it is read, so that only one batch of entries is held in memory at a time.  Runs synchronously,
+ * like retrieveEntries:fromSoup:.
+ * @param soupEntryIds The soup entry IDs to retrieve.
+ * @param soupName The soup to retrieve from.
+ * @param batchSize IDs per batch; 0 or anything above kChunkedRetrieveMaximumBatchSize
+ * uses kChunkedRetrieveMaximumBatchSize.
+ * @param preserveOrder YES to deliver each batch in the order of soupEntryIds.  Entries
+ * that do not exist are skipped either way.
+ * @param batchBlock Called once per batch, in order.
+ */
+- (void)retrieveEntries:(NSArray *)soupEntryIds fromSoup:(NSString *)soupName batchSize:(NSUInteger)batchSize preserveOrder:(BOOL)preserveOrder batchBlock:(ChunkedRetrieveBatchBlock)batchBlock;
+
+@end
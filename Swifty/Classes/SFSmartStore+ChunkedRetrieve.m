@@ -0,0 +1,64 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "SFSmartStore+ChunkedRetrieve.h"
+
+NSUInteger const kChunkedRetrieveMaximumBatchSize = 999;
+
+// Set by the store on every entry.
+static NSString * const kSoupEntryIdKey = @"_soupEntryId";
+
+@implementation SFSmartStore (ChunkedRetrieve)
+
+- (void)retrieveEntries:(NSArray *)soupEntryIds fromSoup:(NSString *)soupName batchSize:(NSUInteger)batchSize preserveOrder:(BOOL)preserveOrder batchBlock:(ChunkedRetrieveBatchBlock)batchBlock
+{
+    if (batchSize == 0 || batchSize > kChunkedRetrieveMaximumBatchSize) {
+        batchSize = kChunkedRetrieveMaximumBatchSize;
+    }
+    
+    for (NSUInteger start = 0; start < [soupEntryIds count]; start += batchSize) {
+        @autoreleasepool {
+            NSArray *batchIds = [soupEntryIds subarrayWithRange:NSMakeRange(start, MIN(batchSize, [soupEntryIds count] - start))];
+            NSArray *entries = [self retrieveEntries:batchIds fromSoup:soupName];
+            if (preserveOrder) {
+                // IDs may be passed as numbers or strings; key both sides by their integer value.
+                NSMutableDictionary *entriesById = [NSMutableDictionary dictionaryWithCapacity:[entries count]];
+                for (NSDictionary *entry in entries) {
+                    [entriesById setObject:entry forKey:@([[entry objectForKey:kSoupEntryIdKey] longLongValue])];
+                }
+                NSMutableArray *orderedEntries = [NSMutableArray arrayWithCapacity:[entries count]];
+                for (id soupEntryId in batchIds) {
+                    NSDictionary *entry = [entriesById objectForKey:@([soupEntryId longLongValue])];
+                    if (entry != nil) {
+                        [orderedEntries addObject:entry];
+                    }
+                }
+                entries = orderedEntries;
+            }
+            batchBlock(entries);
+        }
+    }
+}
+
+@end
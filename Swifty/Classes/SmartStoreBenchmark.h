@@ -0,0 +1,85 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Drives SFSmartStore through its public API against a scratch store filled with a
+ * reproducible synthetic soup, and reports per-operation latencies as JSON.
+ *
+ * The report has the SDK version, the configuration and, for each operation, the sample
+ * count, p50/p99/mean latency in milliseconds and throughput in operations (or rows, for
+ * upsert and remove) per second. Reports from different SDK versions run with the same
+ * configuration are directly comparable.
+ */
+@interface SmartStoreBenchmark : NSObject
+
+/**
+ * Number of entries in the synthetic soup.  Defaults to 10000.
+ */
+@property (nonatomic, assign) NSUInteger entryCount;
+
+/**
+ * Number of indexed fields, at most fieldCount.  Defaults to 4.
+ */
+@property (nonatomic, assign) NSUInteger indexCount;
+
+/**
+ * Number of top-level fields per entry.  Defaults to 10.
+ */
+@property (nonatomic, assign) NSUInteger fieldCount;
+
+/**
+ * Depth of the nested object carried by each entry, to vary the JSON shape.  Defaults to 2.
+ */
+@property (nonatomic, assign) NSUInteger nestingDepth;
+
+/**
+ * Entries per upsert and remove call.  Defaults to 100.
+ */
+@property (nonatomic, assign) NSUInteger batchSize;
+
+/**
+ * Page size for queries and cursor paging.  Defaults to 100.
+ */
+@property (nonatomic, assign) NSUInteger pageSize;
+
+/**
+ * Samples taken for each retrieve, query and count operation.  Defaults to 100.
+ */
+@property (nonatomic, assign) NSUInteger iterations;
+
+/**
+ * Seed for the synthetic data and query keys.  Defaults to 1.
+ */
+@property (nonatomic, assign) uint32_t seed;
+
+/**
+ * Runs the benchmark synchronously; call it off the main thread.  The scratch store is
+ * created for the current user and removed afterwards.
+ * @return the report as JSON data
+ */
+- (NSData *)run;
+
+@end
@@ -0,0 +1,290 @@
+/*
+ Copyright (c) 2014, salesforce.com, inc. All rights reserved.
+ 
+ Redistribution and use of this software in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions
+ and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials provided
+ with the distribution.
+ * Neither the name of salesforce.com, inc. nor the names of its contributors may be used to
+ endorse or promote products derived from this software without specific prior written
+ permission of salesforce.com, inc.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <mach/mach_time.h>
+#import <UIKit/UIKit.h>
+#import <SalesforceSDKCore/SalesforceSDKConstants.h>
+#import <SalesforceSDKCore/SFSmartStore.h>
+#import <SalesforceSDKCore/SFQuerySpec.h>
+#import <SalesforceSDKCore/SFSoupIndex.h>
+#import <SalesforceSDKCore/SFStoreCursor.h>
+#import "SmartStoreBenchmark.h"
+
+static NSString * const kBenchmarkStoreName = @"SmartStoreBenchmark";
+static NSString * const kBenchmarkSoupName = @"BenchmarkSoup";
+
+// Distinct values of the string fields, so exact queries match entryCount / kBenchmarkFieldCardinality entries.
+static uint32_t const kBenchmarkFieldCardinality = 50;
+static uint32_t const kBenchmarkMaximumAmount = 1000000;
+
+// Keys read by -[SFSoupIndex initWithIndexSpec:] and set by the store on every entry.
+static NSString * const kIndexSpecPathKey = @"path";
+static NSString * const kIndexSpecTypeKey = @"type";
+static NSString * const kSoupEntryIdKey = @"_soupEntryId";
+
+@interface SmartStoreBenchmark ()
+
+@property (nonatomic, assign) uint32_t randomState;
+@property (nonatomic, strong) NSMutableDictionary *samplesByOperation;
+@property (nonatomic, strong) NSMutableDictionary *rowsByOperation;
+
+@end
+
+@implementation SmartStoreBenchmark
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _entryCount = 10000;
+        _indexCount = 4;
+        _fieldCount = 10;
+        _nestingDepth = 2;
+        _batchSize = 100;
+        _pageSize = 100;
+        _iterations = 100;
+        _seed = 1;
+    }
+    return self;
+}
+
+- (NSData *)run
+{
+    self.randomState = (self.seed != 0 ? self.seed : 1);
+    self.samplesByOperation = [NSMutableDictionary dictionary];
+    self.rowsByOperation = [NSMutableDictionary dictionary];
+    NSUInteger fieldCount = MAX(self.fieldCount, 2);
+    NSUInteger indexCount = MAX(MIN(self.indexCount, fieldCount), 1);
+    NSUInteger batchSize = MAX(self.batchSize, 1);
+    
+    [SFSmartStore removeSharedStoreWithName:kBenchmarkStoreName];
+    SFSmartStore *store = [SFSmartStore sharedStoreWithName:kBenchmarkStoreName];
+    
+    NSMutableArray *indexSpecs = [NSMutableArray arrayWithCapacity:indexCount];
+    for (NSUInteger i = 0; i < indexCount; i++) {
+        [indexSpecs addObject:@{ kIndexSpecPathKey: [self fieldNameAtIndex:i],
+                                 kIndexSpecTypeKey: (i == 1 ? kSoupIndexTypeInteger : kSoupIndexTypeString) }];
+    }
+    [self measure:@"registerSoup" rows:0 block:^{
+        [store registerSoup:kBenchmarkSoupName withIndexSpecs:indexSpecs];
+    }];
+    
+    // Upsert, keeping the generated soup entry IDs for the retrieve and remove runs.
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:self.entryCount];
+    for (NSUInteger i = 0; i < self.entryCount; i++) {
+        [entries addObject:[self entryAtIndex:i fieldCount:fieldCount]];
+    }
+    NSMutableArray *soupEntryIds = [NSMutableArray arrayWithCapacity:self.entryCount];
+    for (NSUInteger start = 0; start < [entries count]; start += batchSize) {
+        NSArray *batch = [entries subarrayWithRange:NSMakeRange(start, MIN(batchSize, [entries count] - start))];
+        __block NSArray *upserted = nil;
+        [self measure:@"upsert" rows:[batch count] block:^{
+            upserted = [store upsertEntries:batch toSoup:kBenchmarkSoupName];
+        }];
+        for (NSDictionary *entry in upserted) {
+            [soupEntryIds addObject:[entry objectForKey:kSoupEntryIdKey]];
+        }
+    }
+    
+    for (NSUInteger i = 0; i < self.iterations && [soupEntryIds count] > 0; i++) {
+        NSArray *ids = @[ [soupEntryIds objectAtIndex:[self nextRandom] % [soupEntryIds count]] ];
+        [self measure:@"retrieveById" rows:1 block:^{
+            [store retrieveEntries:ids fromSoup:kBenchmarkSoupName];
+        }];
+    }
+    
+    // Field 0 is the entry name, field 1 the integer amount (indexed when indexCount > 1).
+    NSString *namePath = [self fieldNameAtIndex:0];
+    NSString *amountPath = [self fieldNameAtIndex:1];
+    for (NSUInteger i = 0; i < self.iterations; i++) {
+        NSString *name = [self nameAtIndex:[self nextRandom] % MAX(self.entryCount, 1)];
+        SFQuerySpec *exactSpec = [SFQuerySpec newExactQuerySpec:kBenchmarkSoupName withPath:namePath withMatchKey:name
+                                                      withOrder:kSFSoupQuerySortOrderAscending withPageSize:self.pageSize];
+        [self measureQuery:@"exactQuery" spec:exactSpec store:store];
+        
+        NSString *rangePath = (indexCount > 1 ? amountPath : namePath);
+        uint32_t low = [self nextRandom] % kBenchmarkMaximumAmount;
+        NSString *beginKey = (indexCount > 1 ? [NSString stringWithFormat:@"%u", low] : name);
+        NSString *endKey = (indexCount > 1 ? [NSString stringWithFormat:@"%u", low + kBenchmarkMaximumAmount / 100] : [name stringByAppendingString:@"~"]);
+        SFQuerySpec *rangeSpec = [SFQuerySpec newRangeQuerySpec:kBenchmarkSoupName withPath:rangePath withBeginKey:beginKey withEndKey:endKey
+                                                      withOrder:kSFSoupQuerySortOrderAscending withPageSize:self.pageSize];
+        [self measureQuery:@"rangeQuery" spec:rangeSpec store:store];
+        
+        NSString *likeKey = [NSString stringWithFormat:@"%%%03u%%", [self nextRandom] % 1000];
+        SFQuerySpec *likeSpec = [SFQuerySpec newLikeQuerySpec:kBenchmarkSoupName withPath:namePath withLikeKey:likeKey
+                                                    withOrder:kSFSoupQuerySortOrderAscending withPageSize:self.pageSize];
+        [self measureQuery:@"likeQuery" spec:likeSpec store:store];
+        
+        NSString *smartSql = [NSString stringWithFormat:@"SELECT {%@:_soup} FROM {%@} WHERE {%@:%@} = '%@'",
+                              kBenchmarkSoupName, kBenchmarkSoupName, kBenchmarkSoupName, namePath, name];
+        SFQuerySpec *smartSpec = [SFQuerySpec newSmartQuerySpec:smartSql withPageSize:self.pageSize];
+        [self measureQuery:@"smartQuery" spec:smartSpec store:store];
+        
+        [self measure:@"count" rows:1 block:^{
+            [store countWithQuerySpec:rangeSpec];
+        }];
+    }
+    
+    // Cursor paging over the whole soup, in index order.
+    SFQuerySpec *allSpec = [SFQuerySpec newRangeQuerySpec:kBenchmarkSoupName withPath:namePath withBeginKey:nil withEndKey:nil
+                                                withOrder:kSFSoupQuerySortOrderAscending withPageSize:self.pageSize];
+    SFStoreCursor *cursor = [store queryWithQuerySpec:[allSpec asDictionary] withSoupName:kBenchmarkSoupName];
+    NSUInteger totalPages = [cursor.totalPages unsignedIntegerValue];
+    for (NSUInteger page = 1; page < totalPages; page++) {
+        [self measure:@"cursorPage" rows:1 block:^{
+            cursor.currentPageIndex = @(page);
+        }];
+    }
+    [cursor close];
+    
+    for (NSUInteger start = 0; start < [soupEntryIds count]; start += batchSize) {
+        NSArray *batch = [soupEntryIds subarrayWithRange:NSMakeRange(start, MIN(batchSize, [soupEntryIds count] - start))];
+        [self measure:@"remove" rows:[batch count] block:^{
+            [store removeEntries:batch fromSoup:kBenchmarkSoupName];
+        }];
+    }
+    
+    [SFSmartStore removeSharedStoreWithName:kBenchmarkStoreName];
+    return [NSJSONSerialization dataWithJSONObject:[self report] options:NSJSONWritingPrettyPrinted error:NULL];
+}
+
+#pragma mark - Private methods
+
+- (void)measure:(NSString *)operation rows:(NSUInteger)rows block:(void (^)(void))block
+{
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    
+    uint64_t start = mach_absolute_time();
+    block();
+    uint64_t elapsed = mach_absolute_time() - start;
+    double milliseconds = (double)elapsed * timebase.numer / timebase.denom / NSEC_PER_MSEC;
+    
+    NSMutableArray *samples = [self.samplesByOperation objectForKey:operation];
+    if (samples == nil) {
+        samples = [NSMutableArray array];
+        [self.samplesByOperation setObject:samples forKey:operation];
+    }
+    [samples addObject:@(milliseconds)];
+    NSUInteger totalRows = [[self.rowsByOperation objectForKey:operation] unsignedIntegerValue] + MAX(rows, 1);
+    [self.rowsByOperation setObject:@(totalRows) forKey:operation];
+}
+
+- (void)measureQuery:(NSString *)operation spec:(SFQuerySpec *)spec store:(SFSmartStore *)store
+{
+    [self measure:operation rows:1 block:^{
+        [store queryWithQuerySpec:spec pageIndex:0];
+    }];
+}
+
+- (NSDictionary *)report
+{
+    NSMutableDictionary *results = [NSMutableDictionary dictionaryWithCapacity:[self.samplesByOperation count]];
+    for (NSString *operation in self.samplesByOperation) {
+        NSArray *samples = [[self.samplesByOperation objectForKey:operation] sortedArrayUsingSelector:@selector(compare:)];
+        double total = [[samples valueForKeyPath:@"@sum.self"] doubleValue];
+        NSUInteger rows = [[self.rowsByOperation objectForKey:operation] unsignedIntegerValue];
+        [results setObject:@{ @"samples": @([samples count]),
+                              @"p50Ms": [self percentile:0.50 ofSortedSamples:samples],
+                              @"p99Ms": [self percentile:0.99 ofSortedSamples:samples],
+                              @"meanMs": @(total / [samples count]),
+                              @"perSecond": @(total > 0 ? rows / (total / 1000.0) : 0) }
+                    forKey:operation];
+    }
+    
+    return @{ @"sdkVersion": SALESFORCE_SDK_VERSION,
+              @"device": [[UIDevice currentDevice] model],
+              @"systemVersion": [[UIDevice currentDevice] systemVersion],
+              @"configuration": @{ @"entryCount": @(self.entryCount),
+                                   @"indexCount": @(self.indexCount),
+                                   @"fieldCount": @(self.fieldCount),
+                                   @"nestingDepth": @(self.nestingDepth),
+                                   @"batchSize": @(self.batchSize),
+                                   @"pageSize": @(self.pageSize),
+                                   @"iterations": @(self.iterations),
+                                   @"seed": @(self.seed) },
+              @"results": results };
+}
+
+// Nearest-rank percentile.
+- (NSNumber *)percentile:(double)percentile ofSortedSamples:(NSArray *)samples
+{
+    NSUInteger rank = (NSUInteger)ceil(percentile * [samples count]);
+    return [samples objectAtIndex:(rank > 0 ? rank - 1 : 0)];
+}
+
+// xorshift32, so the same seed always yields the same soup and query keys.
+- (uint32_t)nextRandom
+{
+    uint32_t x = self.randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    self.randomState = x;
+    return x;
+}
+
+- (NSString *)fieldNameAtIndex:(NSUInteger)index
+{
+    switch (index) {
+        case 0:  return @"Name";
+        case 1:  return @"Amount";
+        default: return [NSString stringWithFormat:@"Field%lu", (unsigned long)index];
+    }
+}
+
+- (NSString *)nameAtIndex:(NSUInteger)index
+{
+    return [NSString stringWithFormat:@"Entry %08lu", (unsigned long)index];
+}
+
+- (NSDictionary *)entryAtIndex:(NSUInteger)index fieldCount:(NSUInteger)fieldCount
+{
+    NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithCapacity:fieldCount + 1];
+    [entry setObject:[self nameAtIndex:index] forKey:[self fieldNameAtIndex:0]];
+    [entry setObject:@([self nextRandom] % kBenchmarkMaximumAmount) forKey:[self fieldNameAtIndex:1]];
+    for (NSUInteger i = 2; i < fieldCount; i++) {
+        NSString *value = [NSString stringWithFormat:@"Value %u", [self nextRandom] % kBenchmarkFieldCardinality];
+        [entry setObject:value forKey:[self fieldNameAtIndex:i]];
+    }
+    
+    NSMutableDictionary *nested = nil;
+    for (NSUInteger depth = 0; depth < self.nestingDepth; depth++) {
+        NSMutableDictionary *level = [NSMutableDictionary dictionaryWithObject:[NSString stringWithFormat:@"Level %lu", (unsigned long)depth]
+                                                                        forKey:@"Label"];
+        if (nested != nil) {
+            [level setObject:nested forKey:@"Child"];
+        }
+        nested = level;
+    }
+    if (nested != nil) {
+        [entry setObject:nested forKey:@"Nested"];
+    }
+    return entry;
+}
+
+@end
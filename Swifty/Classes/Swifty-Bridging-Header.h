@@ -4,4 +4,10 @@
 
 #import <UIKit/UIKit.h>
 #import "SFRestAPI.h"
-#import "SFRestRequest.h"
\ No newline at end of file
+#import "SFRestRequest.h"
+#import "SFQuerySpec+Aggregate.h"
+#import "SFSmartStore+ChunkedRetrieve.h"
+#import "SFRestAPI+QueryAllPages.h"
+#import "SFRestAPI+Batch.h"
+#import "SFRestAPI+ResponseCache.h"
+#import "SFRestAPI+SingleFlight.h"
\ No newline at end of file